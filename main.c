@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <threads.h>
 
 /* Define Constants */
 #define MAX_PRODUCTS 100
@@ -9,6 +10,14 @@
 #define STR_LEN 50
 #define PRODUCTS_FILE "products.txt"
 #define SALES_FILE "sales_records.txt"
+#define DEFAULT_REORDER_THRESHOLD 5
+#define VELOCITY_WINDOW_DAYS 30 // Sales velocity is measured over this many recent days
+#define MAX_STORES 16
+#define STORES_FILE "stores.txt"
+#define DEFAULT_STORE_ID 1
+#define REPORT_THREADS 4 // Worker threads used for chain-wide report fan-out
+#define CUSTOMER_SLOTS (2 * MAX_SALES) // Customer hash table size, kept at most half full
+#define PRODUCT_SLOTS (2 * MAX_PRODUCTS) // Product ID hash table size, kept at most half full
 
 /* Data Structures */
 typedef struct {
@@ -23,6 +32,7 @@ typedef struct {
     float price;
     int quantity_in_stock;
     Warranty warranty;
+    int reorder_threshold; // Reorder when stock falls to or below this level
 } Product;
 
 typedef struct {
@@ -32,6 +42,105 @@ typedef struct {
     int quantity_sold;
 } SaleRecord;
 
+/*
+Reorder queue: an indexed min-heap of product slots keyed on
+(quantity_in_stock - reorder_threshold). pos[] maps a product slot to its
+heap position so a single product can be re-keyed in O(log n).
+Recent sales are kept in per-product day buckets (one per day of the
+velocity window) so days of cover never requires a ledger scan.
+*/
+typedef struct {
+    int heap[MAX_PRODUCTS];  // Heap position -> product slot
+    int pos[MAX_PRODUCTS];   // Product slot -> heap position
+    int size;
+    int bucket_day[MAX_PRODUCTS][VELOCITY_WINDOW_DAYS]; // Day number held by each bucket (-1 = empty)
+    int bucket_qty[MAX_PRODUCTS][VELOCITY_WINDOW_DAYS]; // Units sold on that day
+    int latest_day;          // Most recent sale day seen, end of the velocity window
+} ReorderQueue;
+
+/*
+Customer index: an open-addressed hash table from customer name to that
+customer's sales. Each sale links to the customer's next sale in ledger
+order, so a lookup walks only that customer's purchases and returns.
+Names are not copied; a slot is compared via its first sale's record.
+*/
+typedef struct {
+    int first_sale[CUSTOMER_SLOTS]; // First ledger offset of the customer in each slot (-1 = empty)
+    int last_sale[CUSTOMER_SLOTS];  // Last ledger offset, where new sales are linked
+    int next_sale[MAX_SALES];       // Next ledger offset of the same customer (-1 = end)
+} CustomerIndex;
+
+/*
+Product ID index: an open-addressed hash table from product_id to the
+product's slot in the catalog array, so customer lookups and returns find
+a product without scanning the catalog. Sorting moves products between
+slots, so the index is rebuilt afterwards, like the reorder queue.
+*/
+typedef struct {
+    int slot[PRODUCT_SLOTS]; // Catalog slot held by each hash slot (-1 = empty)
+} ProductIndex;
+
+/*
+Store shard: one store's catalog and ledger, with its own data files and
+reorder queue. Stores are listed in stores.txt; without it the system runs
+a single store on the original products.txt / sales_records.txt pair.
+*/
+typedef struct {
+    int store_id;
+    char store_name[STR_LEN];
+    char products_file[STR_LEN];
+    char sales_file[STR_LEN];
+    Product products[MAX_PRODUCTS];
+    int p_count;
+    SaleRecord sales[MAX_SALES];
+    int s_count;
+    ReorderQueue reorder;
+    CustomerIndex customers;
+    ProductIndex product_ids;
+} StoreShard;
+
+/* Per-shard partial results merged by the chain-wide reports */
+typedef struct {
+    float revenue;
+    int records;
+} RevenuePartial;
+
+typedef struct {
+    int sale_idx[MAX_SALES];    // Matching sales in the shard's ledger
+    int product_idx[MAX_SALES]; // Product slot of each match, -1 if unknown
+    int count;
+    float revenue;
+} MonthlyPartial;
+
+/* Shard task: fills result for one shard, reading shared parameters from arg */
+typedef void (*ShardTask)(StoreShard* store, void* result, void* arg);
+
+typedef struct {
+    StoreShard* shards;
+    int store_count;
+    ShardTask task;
+    void* results;      // Array of store_count results, result_size bytes each
+    size_t result_size;
+    void* arg;
+    int next;           // Next shard to hand out, guarded by the pool lock
+} ShardFanOut;
+
+/*
+Report thread pool: REPORT_THREADS - 1 workers started once at startup and
+kept for the life of the process. Each fan-out posts a job, bumps the
+generation and helps on the calling thread until every worker has checked in.
+*/
+typedef struct {
+    thrd_t threads[REPORT_THREADS];
+    int thread_count;   // Workers actually started, 0 = run jobs inline
+    mtx_t lock;
+    cnd_t work_ready;   // Signalled when a new job is posted
+    cnd_t work_done;    // Signalled when the last worker finishes a job
+    ShardFanOut* job;   // Current job
+    int generation;     // Incremented per job so a worker runs each job once
+    int active;         // Workers still working on the current job
+} ShardPool;
+
 /* Function Prototypes */
 void parse_csv_line_product(char* line, Product* p);
 void parse_csv_line_sale(char* line, SaleRecord* s);
@@ -40,21 +149,56 @@ int LoadSalesData(SaleRecord sales[], int* s_count, const char* filename);
 void SaveProducts(Product products[], int p_count, const char* filename);
 void AppendSaleToFile(SaleRecord* sale, const char* filename);
 void PrintSingleProduct(Product* p);
+int DateToDays(const char* date);
+int ParseMonthYear(const char* text);
+int ParseLedgerDate(const char* date);
+
+/* Store Shard Functions */
+int LoadStores(StoreShard shards[], int* store_count, const char* filename);
+void LoadStoreShard(StoreShard* store);
+StoreShard* FindStore(StoreShard shards[], int store_count, int store_id);
+void ShardPoolStart(ShardPool* pool);
+void RunShardFanOut(ShardPool* pool, StoreShard shards[], int store_count, ShardTask task, void* results, size_t result_size, void* arg);
+void revenue_shard_task(StoreShard* store, void* result, void* arg);
+void monthly_shard_task(StoreShard* store, void* result, void* arg);
+
+/* Reorder Engine Functions */
+int reorder_key(Product products[], int idx);
+void ReorderBuild(ReorderQueue* rq, Product products[], int p_count, SaleRecord sales[], int s_count);
+void ReorderInsert(ReorderQueue* rq, Product products[], int idx);
+void ReorderUpdate(ReorderQueue* rq, Product products[], int idx);
+void ReorderRecordSale(ReorderQueue* rq, int idx, const char* date, int qty);
+
+/* Customer Index Functions */
+void CustomerIndexBuild(CustomerIndex* ci, SaleRecord sales[], int s_count);
+void CustomerIndexAdd(CustomerIndex* ci, SaleRecord sales[], int offset);
+int CustomerFirstSale(CustomerIndex* ci, SaleRecord sales[], const char* name);
+
+/* Product ID Index Functions */
+void ProductIndexBuild(ProductIndex* pi, Product products[], int p_count);
+void ProductIndexAdd(ProductIndex* pi, Product products[], int idx);
+int ProductFindSlot(ProductIndex* pi, Product products[], int product_id);
 
 /* Existing Core Logic Functions */
-void Menu_ModifyLastProduct(Product products[], int p_count);
-void Menu_AddNewProduct(Product products[], int* p_count);
-void Menu_SellProduct(Product products[], int p_count, SaleRecord sales[], int* s_count);
+void Menu_ModifyLastProduct(StoreShard* store);
+void Menu_AddNewProduct(StoreShard* store);
+void Menu_SellProduct(StoreShard* store);
 void Menu_SortProducts(Product products[], int p_count);
 void Menu_PrintProducts(Product products[], int p_count);
 void Menu_RevenueReport(Product products[], int p_count, SaleRecord sales[], int s_count);
-void Menu_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int s_count);
+void Menu_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int s_count, int store_id);
+void Menu_ReorderReport(Product products[], ReorderQueue* rq);
+void Menu_CustomerHistory(StoreShard* store);
+void Menu_ProcessReturn(StoreShard* store);
+void Menu_SwitchStore(StoreShard shards[], int store_count, StoreShard** store);
+void Menu_ChainRevenueReport(ShardPool* pool, StoreShard shards[], int store_count);
+void Menu_ChainMonthlyReport(ShardPool* pool, StoreShard shards[], int store_count);
 
 /* New Assignment Task Wrapper Functions (Q1-Q4) */
-void Q1_Task_Initialization(Product products[], int p_count, SaleRecord sales[], int* s_count);
+void Q1_Task_Initialization(StoreShard* store);
 void Q2_Task_Sorting(Product products[], int p_count);
 void Q3_Task_Revenue(Product products[], int p_count, SaleRecord sales[], int s_count);
-void Q4_Task_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int s_count);
+void Q4_Task_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int s_count, int store_id);
 
 /*
 @function: clear_buffer
@@ -75,36 +219,38 @@ void clear_buffer() {
 @return: int - Returns 0 upon successful execution
 */
 int main() {
-    Product products[MAX_PRODUCTS];
-    SaleRecord sales[MAX_SALES];
-    int p_count = 0;
-    int s_count = 0;
+    static StoreShard shards[MAX_STORES]; // Static: each shard holds full tables
+    static ShardPool pool;
+    int store_count = 0;
     int choice;
 
     // --- Initialization ---
     printf("Initializing System...\n");
 
-    // Load products from file at startup
-    if (!LoadProducts(products, &p_count, PRODUCTS_FILE)) {
-        printf("Warning: Failed to load products or file empty.\n");
-    }
-    else {
-        printf("Loaded %d products.\n", p_count);
+    // Read the store list, falling back to a single store on the original files
+    if (!LoadStores(shards, &store_count, STORES_FILE)) {
+        shards[0].store_id = DEFAULT_STORE_ID;
+        strcpy(shards[0].store_name, "Main Store");
+        strcpy(shards[0].products_file, PRODUCTS_FILE);
+        strcpy(shards[0].sales_file, SALES_FILE);
+        store_count = 1;
     }
 
-    // Load sales records from file at startup
-    if (!LoadSalesData(sales, &s_count, SALES_FILE)) {
-        printf("Warning: Failed to load sales or file empty.\n");
-    }
-    else {
-        printf("Loaded %d sales records.\n", s_count);
+    // Load every shard's catalog and ledger
+    for (int i = 0; i < store_count; i++) {
+        LoadStoreShard(&shards[i]);
     }
+    StoreShard* store = &shards[0]; // Store that operational commands act on
+
+    // Start the report workers once; chain-wide reports reuse them
+    ShardPoolStart(&pool);
     printf("System Ready.\n\n");
 
     // --- Main Menu Loop ---
     // Runs indefinitely until the user selects Exit (0)
     while (1) {
         printf("\n=== Product Sales Management System ===\n");
+        printf("Current Store: %d (%s)\n", store->store_id, store->store_name);
         printf("--- Operational Menu ---\n");
         printf("1. Modify Last Product Info\n");
         printf("2. Add New Product\n");
@@ -113,6 +259,14 @@ int main() {
         printf("5. Print Product List\n");
         printf("6. Revenue Calculation Report\n");
         printf("7. Generate Monthly Sales Report\n");
+        printf("12. Show Products Needing Reorder\n");
+        printf("--- Chain Menu ---\n");
+        printf("13. Switch Store\n");
+        printf("14. Chain-wide Revenue Report\n");
+        printf("15. Chain-wide Monthly Sales Report\n");
+        printf("--- Customer Menu ---\n");
+        printf("16. Customer Purchase History\n");
+        printf("17. Process a Return (Restock & Refund)\n");
         printf("--- Assignment Task Demos ---\n");
         printf("8. Show Q1 (Init & Validation)\n");
         printf("9. Show Q2 (Sorting Demo)\n");
@@ -131,37 +285,60 @@ int main() {
         // Handle user selection
         switch (choice) {
         case 1:
-            Menu_ModifyLastProduct(products, p_count);
+            Menu_ModifyLastProduct(store);
             break;
         case 2:
-            Menu_AddNewProduct(products, &p_count);
+            Menu_AddNewProduct(store);
             break;
         case 3:
-            Menu_SellProduct(products, p_count, sales, &s_count);
+            Menu_SellProduct(store);
             break;
         case 4:
-            Menu_SortProducts(products, p_count);
+            Menu_SortProducts(store->products, store->p_count);
+            // Sorting moves products between slots, so the heap and ID index must be rebuilt
+            ReorderBuild(&store->reorder, store->products, store->p_count, store->sales, store->s_count);
+            ProductIndexBuild(&store->product_ids, store->products, store->p_count);
             break;
         case 5:
-            Menu_PrintProducts(products, p_count);
+            Menu_PrintProducts(store->products, store->p_count);
             break;
         case 6:
-            Menu_RevenueReport(products, p_count, sales, s_count);
+            Menu_RevenueReport(store->products, store->p_count, store->sales, store->s_count);
             break;
         case 7:
-            Menu_MonthlyReport(products, p_count, sales, s_count);
+            Menu_MonthlyReport(store->products, store->p_count, store->sales, store->s_count, store->store_id);
             break;
         case 8: // Call Q1 Function
-            Q1_Task_Initialization(products, p_count, sales, &s_count);
+            Q1_Task_Initialization(store);
             break;
         case 9: // Call Q2 Function
-            Q2_Task_Sorting(products, p_count);
+            Q2_Task_Sorting(store->products, store->p_count);
+            ReorderBuild(&store->reorder, store->products, store->p_count, store->sales, store->s_count);
+            ProductIndexBuild(&store->product_ids, store->products, store->p_count);
             break;
         case 10: // Call Q3 Function
-            Q3_Task_Revenue(products, p_count, sales, s_count);
+            Q3_Task_Revenue(store->products, store->p_count, store->sales, store->s_count);
             break;
         case 11: // Call Q4 Function
-            Q4_Task_MonthlyReport(products, p_count, sales, s_count);
+            Q4_Task_MonthlyReport(store->products, store->p_count, store->sales, store->s_count, store->store_id);
+            break;
+        case 12:
+            Menu_ReorderReport(store->products, &store->reorder);
+            break;
+        case 13:
+            Menu_SwitchStore(shards, store_count, &store);
+            break;
+        case 14:
+            Menu_ChainRevenueReport(&pool, shards, store_count);
+            break;
+        case 15:
+            Menu_ChainMonthlyReport(&pool, shards, store_count);
+            break;
+        case 16:
+            Menu_CustomerHistory(store);
+            break;
+        case 17:
+            Menu_ProcessReturn(store);
             break;
         case 0:
             printf("Exiting system. Goodbye!\n");
@@ -179,37 +356,34 @@ int main() {
 @function: Q1_Task_Initialization
 @desc: Demonstrates Task 1: Modifies the last product, programmatically adds 5 sales,
        and validates data by printing the first 3 records.
-@param: products[] - The array of products
-@param: p_count - The current number of products
-@param: sales[] - The array of sales records
-@param: s_count - Pointer to the sales counter to allow updates
+@param: store - The store shard to operate on
 @return: void
 */
-void Q1_Task_Initialization(Product products[], int p_count, SaleRecord sales[], int* s_count) {
+void Q1_Task_Initialization(StoreShard* store) {
     printf("\n=== [Q1 Demo] Product Database Initialization & Validation ===\n");
 
     // Requirement 1: Modify the last entry 
     printf("Step 1: Modifying the last entry...\n");
-    Menu_ModifyLastProduct(products, p_count);
+    Menu_ModifyLastProduct(store);
 
     // Requirement 2: Append 5 new sales records to sales_records.txt programmatically. 
     printf("\nStep 2: Appending 5 new sales records...\n");
     for (int i = 0; i < 5; i++) {
         printf("\nAdd record %d\n", i + 1);
         // Calls the sell function to update memory and file simultaneously
-        Menu_SellProduct(products, p_count, sales, s_count);
+        Menu_SellProduct(store);
     }
 
     // Requirement 3: Validate data integrity by printing the first 3 product records 
     printf("\nStep 3: Validating Data (First 3 Products)...\n");
     printf("%-5s %-30s %-15s %-10s\n", "ID", "Name", "Brand", "Price");
     printf("------------------------------------------------------------\n");
-    for (int i = 0; i < 3 && i < p_count; i++) {
+    for (int i = 0; i < 3 && i < store->p_count; i++) {
         printf("%-5d %-30s %-15s %-10.2f\n",
-            products[i].product_id,
-            products[i].product_name,
-            products[i].brand,
-            products[i].price);
+            store->products[i].product_id,
+            store->products[i].product_name,
+            store->products[i].brand,
+            store->products[i].price);
     }
 }
 
@@ -253,12 +427,13 @@ void Q3_Task_Revenue(Product products[], int p_count, SaleRecord sales[], int s_
 @param: p_count - Number of products
 @param: sales[] - Array of sales
 @param: s_count - Number of sales
+@param: store_id - Store the report is generated for
 @return: void
 */
-void Q4_Task_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int s_count) {
+void Q4_Task_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int s_count, int store_id) {
     printf("\n=== [Q4 Demo] Monthly Sales Report Generation ===\n");
     // Reuse existing monthly report logic
-    Menu_MonthlyReport(products, p_count, sales, s_count);
+    Menu_MonthlyReport(products, p_count, sales, s_count, store_id);
 }
 
 
@@ -268,11 +443,12 @@ void Q4_Task_MonthlyReport(Product products[], int p_count, SaleRecord sales[],
 @function: Menu_ModifyLastProduct
 @desc: Allows the user to select and modify attributes of the last product in the database.
        It saves changes to the file immediately.
-@param: products[] - Array of products
-@param: p_count - Current number of products
+@param: store - Store shard whose catalog is modified
 @return: void
 */
-void Menu_ModifyLastProduct(Product products[], int p_count) {
+void Menu_ModifyLastProduct(StoreShard* store) {
+    Product* products = store->products;
+    int p_count = store->p_count;
     if (p_count == 0) {
         printf("Error: No products in database to modify.\n");
         return;
@@ -294,6 +470,7 @@ void Menu_ModifyLastProduct(Product products[], int p_count) {
     printf("4. Stock Quantity\n");
     printf("5. Warranty Months\n");
     printf("6. Warranty Provider\n");
+    printf("7. Reorder Threshold\n");
     printf("0. Cancel\n");
     printf("Select attribute to modify: ");
 
@@ -317,6 +494,7 @@ void Menu_ModifyLastProduct(Product products[], int p_count) {
     case 4: scanf("%d", &p->quantity_in_stock); clear_buffer(); break;
     case 5: scanf("%d", &p->warranty.warranty_months); clear_buffer(); break;
     case 6: scanf("%[^\n]", p->warranty.provider); clear_buffer(); break;
+    case 7: scanf("%d", &p->reorder_threshold); clear_buffer(); break;
     default: printf("Invalid selection.\n"); return;
     }
 
@@ -324,19 +502,23 @@ void Menu_ModifyLastProduct(Product products[], int p_count) {
     printf("\n[Updated Information (After Modification)]");
     PrintSingleProduct(p);
 
+    // Stock or threshold may have changed its reorder priority
+    ReorderUpdate(&store->reorder, products, idx);
+
     // Sync changes to disk
-    SaveProducts(products, p_count, PRODUCTS_FILE);
+    SaveProducts(products, p_count, store->products_file);
     printf("\nDatabase updated successfully!\n");
 }
 
 /*
 @function: Menu_AddNewProduct
 @desc: Prompts user for all product details and adds a new product to the list and file.
-@param: products[] - Array of products
-@param: p_count - Pointer to product count (to increment it)
+@param: store - Store shard the product is added to
 @return: void
 */
-void Menu_AddNewProduct(Product products[], int* p_count) {
+void Menu_AddNewProduct(StoreShard* store) {
+    Product* products = store->products;
+    int* p_count = &store->p_count;
     if (*p_count >= MAX_PRODUCTS) {
         printf("Error: Product database full.\n");
         return;
@@ -351,24 +533,30 @@ void Menu_AddNewProduct(Product products[], int* p_count) {
     printf("Enter Stock Quantity: "); scanf("%d", &p->quantity_in_stock);
     printf("Enter Warranty Months: "); scanf("%d", &p->warranty.warranty_months); clear_buffer();
     printf("Enter Warranty Provider: "); scanf("%[^\n]", p->warranty.provider); clear_buffer();
+    printf("Enter Reorder Threshold: "); scanf("%d", &p->reorder_threshold); clear_buffer();
 
-    // Increment count and save
+    // Increment count, index and save
+    ReorderInsert(&store->reorder, products, *p_count);
+    ProductIndexAdd(&store->product_ids, products, *p_count);
     (*p_count)++;
-    SaveProducts(products, *p_count, PRODUCTS_FILE);
+    SaveProducts(products, *p_count, store->products_file);
     printf("Product added and saved successfully.\n");
 }
 
 /*
 @function: Menu_SellProduct
 @desc: Handles a sales transaction. Checks stock, updates product quantity,
-       records the sale, and updates both product and sales files.
-@param: products[] - Array of products
-@param: p_count - Number of products
-@param: sales[] - Array of sales records
-@param: s_count - Pointer to sales count (to increment it)
+       records the sale, and updates both product and sales files of the store shard
+       the sale belongs to.
+@param: store - Store shard the sale is routed to
 @return: void
 */
-void Menu_SellProduct(Product products[], int p_count, SaleRecord sales[], int* s_count) {
+void Menu_SellProduct(StoreShard* store) {
+    Product* products = store->products;
+    int p_count = store->p_count;
+    SaleRecord* sales = store->sales;
+    int* s_count = &store->s_count;
+    ReorderQueue* rq = &store->reorder;
     if (*s_count >= MAX_SALES) {
         printf("Error: Sales database full.\n");
         return;
@@ -398,17 +586,32 @@ void Menu_SellProduct(Product products[], int p_count, SaleRecord sales[], int*
 
     // 3. Get Quantity and validate stock
     printf("Enter Quantity to Sell: ");
-    scanf("%d", &qty);
+    if (scanf("%d", &qty) != 1) qty = 0;
     clear_buffer();
 
+    // Negative quantities are refunds and may only be recorded by Menu_ProcessReturn
+    if (qty <= 0) {
+        printf("Error: Quantity must be positive.\n");
+        return;
+    }
     if (qty > products[p_idx].quantity_in_stock) {
         printf("Error: Insufficient stock!\n");
         return;
     }
 
-    // 4. Get Customer info
-    printf("Enter Customer Name: "); scanf("%[^\n]", customer); clear_buffer();
-    printf("Enter Date (DD/MM/YYYY): "); scanf("%s", date); clear_buffer();
+    // 4. Get Customer info, validated before anything is changed
+    printf("Enter Customer Name: ");
+    if (scanf("%49[^\n]", customer) != 1) {
+        clear_buffer();
+        printf("Error: Customer name cannot be empty.\n");
+        return;
+    }
+    clear_buffer();
+    printf("Enter Date (DD/MM/YYYY): "); scanf("%14s", date); clear_buffer();
+    if (ParseLedgerDate(date) < 0) {
+        printf("Error: Invalid date, expected DD/MM/YYYY.\n");
+        return;
+    }
 
     // 5. Execute Logic: Decrease stock
     products[p_idx].quantity_in_stock -= qty;
@@ -421,9 +624,14 @@ void Menu_SellProduct(Product products[], int p_count, SaleRecord sales[], int*
     strcpy(s->sale_date, date);
     (*s_count)++;
 
-    // 7. Execute Logic: Save to Files
-    AppendSaleToFile(s, SALES_FILE);
-    SaveProducts(products, p_count, PRODUCTS_FILE);
+    // 7. Execute Logic: Re-key the product in the reorder queue
+    ReorderRecordSale(rq, p_idx, date, qty);
+    ReorderUpdate(rq, products, p_idx);
+    CustomerIndexAdd(&store->customers, sales, *s_count - 1);
+
+    // 8. Execute Logic: Save to Files
+    AppendSaleToFile(s, store->sales_file);
+    SaveProducts(products, p_count, store->products_file);
     printf("Transaction completed successfully! Stock updated.\n");
 }
 
@@ -456,11 +664,11 @@ void Menu_SortProducts(Product products[], int p_count) {
 @return: void
 */
 void PrintSingleProduct(Product* p) {
-    printf("\n%-5s %-30s %-15s %-10s %-8s %-10s %-15s\n", "ID", "Name", "Brand", "Price", "Stock", "Warranty", "Provider");
+    printf("\n%-5s %-30s %-15s %-10s %-8s %-10s %-10s %-15s\n", "ID", "Name", "Brand", "Price", "Stock", "Threshold", "Warranty", "Provider");
     printf("----------------------------------------------------------------------------------------------------------\n");
-    printf("%-5d %-30s %-15s %-10.2f %-8d %-10d %-15s\n",
+    printf("%-5d %-30s %-15s %-10.2f %-8d %-10d %-10d %-15s\n",
         p->product_id, p->product_name, p->brand, p->price, p->quantity_in_stock,
-        p->warranty.warranty_months, p->warranty.provider);
+        p->reorder_threshold, p->warranty.warranty_months, p->warranty.provider);
     printf("----------------------------------------------------------------------------------------------------------\n");
 }
 
@@ -472,12 +680,13 @@ void PrintSingleProduct(Product* p) {
 @return: void
 */
 void Menu_PrintProducts(Product products[], int p_count) {
-    printf("\n%-5s %-30s %-15s %-10s %-8s %-10s %-15s\n", "ID", "Name", "Brand", "Price", "Stock", "Warranty", "Provider");
+    printf("\n%-5s %-30s %-15s %-10s %-8s %-10s %-10s %-15s\n", "ID", "Name", "Brand", "Price", "Stock", "Threshold", "Warranty", "Provider");
     printf("--------------------------------------------------------------------------\n");
     for (int i = 0; i < p_count; i++) {
-        printf("%-5d %-30s %-15s %-10.2f %-8d %-10d %-15s\n",
+        printf("%-5d %-30s %-15s %-10.2f %-8d %-10d %-10d %-15s\n",
             products[i].product_id, products[i].product_name, products[i].brand, products[i].price,
-            products[i].quantity_in_stock, products[i].warranty.warranty_months, products[i].warranty.provider);
+            products[i].quantity_in_stock, products[i].reorder_threshold,
+            products[i].warranty.warranty_months, products[i].warranty.provider);
     }
     printf("\n");
 }
@@ -525,15 +734,17 @@ void Menu_RevenueReport(Product products[], int p_count, SaleRecord sales[], int
 /*
 @function: Menu_MonthlyReport
 @desc: Filters sales records for a user-specified month/year and exports them to a text file.
+       The store ID is part of the file name so each store keeps its own report.
 @param: products[] - Array of products
 @param: p_count - Number of products
 @param: sales[] - Array of sales
 @param: s_count - Number of sales
+@param: store_id - Store the sales belong to
 @return: void
 */
-void Menu_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int s_count) {
+void Menu_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int s_count, int store_id) {
     char target_month[10];
-    char filename[50];
+    char filename[60];
     char month_full[12][20] = {
         "January",   
         "February",  
@@ -550,13 +761,17 @@ void Menu_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int
     };
 
     printf("Enter Month/Year (MM/YYYY): ");
-    scanf("%s", target_month);
+    scanf("%9s", target_month);
     // int target_month = 10;
 
-    int mo = (target_month[0] - '0') * 10 + target_month[1] - '0';
+    int mo = ParseMonthYear(target_month);
+    if (mo == 0) {
+        printf("Error: Invalid month, expected MM/YYYY.\n");
+        return;
+    }
     int ye = atoi(&target_month[3]);
     // Create filename
-    sprintf(filename, "%s_Sales_Report_2559321.txt", month_full[mo - 1]);
+    sprintf(filename, "%s_Store%d_Sales_Report_2559321.txt", month_full[mo - 1], store_id);
     for (int i = 0; filename[i]; i++) if (filename[i] == '/') filename[i] = '_';
 
     FILE* fp = fopen(filename, "w");
@@ -565,13 +780,13 @@ void Menu_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int
         return;
     }
 
-    fprintf(fp, "--- Monthly Sales Report: %s ---\n", target_month);
+    fprintf(fp, "--- Monthly Sales Report: Store %d, %s ---\n", store_id, target_month);
     fprintf(fp, "%-10s %-20s %-10s %-10s\n", "Date", "Product Name", "Qty Sold", "Price");
 
     int found = 0;
     for (int i = 0; i < s_count; i++) {
-        // Use strstr to find the month substring in the date string
-        if (strstr(sales[i].sale_date, target_month) != NULL) {
+        // Match the MM/YYYY part of "DD/MM/YYYY" exactly
+        if (strcmp(&sales[i].sale_date[3], target_month) == 0) {
             char p_name[STR_LEN] = "Unknown";
             float p_price = 0.0;
             // Lookup product details
@@ -592,6 +807,921 @@ void Menu_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int
     printf("Report generated: %s (%d records found)\n", filename, found);
 }
 
+/*
+@function: Menu_ReorderReport
+@desc: Lists every product whose stock is at or below its reorder threshold, with days
+       of cover from recent sales velocity. Only heap nodes that need reordering are
+       visited, so the cost is proportional to the number of products listed.
+@param: products[] - Array of products
+@param: rq - Reorder queue built over the products
+@return: void
+*/
+void Menu_ReorderReport(Product products[], ReorderQueue* rq) {
+    int stack[MAX_PRODUCTS];
+    int top = 0;
+    int found = 0;
+
+    printf("\n--- Products Needing Reorder ---\n");
+    printf("%-5s %-30s %-8s %-10s %-10s %-15s\n", "ID", "Name", "Stock", "Threshold", "Shortfall", "Days of Cover");
+    printf("--------------------------------------------------------------------------------\n");
+
+    // Depth-first walk from the root; a child can only qualify if its parent does
+    if (rq->size > 0 && reorder_key(products, rq->heap[0]) <= 0) stack[top++] = 0;
+    while (top > 0) {
+        int h = stack[--top];
+        int idx = rq->heap[h];
+        Product* p = &products[idx];
+
+        // Units sold inside the velocity window ending at the latest sale day
+        int sold = 0;
+        for (int b = 0; b < VELOCITY_WINDOW_DAYS; b++) {
+            if (rq->bucket_day[idx][b] > rq->latest_day - VELOCITY_WINDOW_DAYS) sold += rq->bucket_qty[idx][b];
+        }
+
+        printf("%-5d %-30s %-8d %-10d %-10d ", p->product_id, p->product_name,
+            p->quantity_in_stock, p->reorder_threshold, p->reorder_threshold - p->quantity_in_stock);
+        if (sold > 0) printf("%-15.1f\n", p->quantity_in_stock * (float)VELOCITY_WINDOW_DAYS / sold);
+        else printf("%-15s\n", "N/A");
+        found++;
+
+        for (int c = 2 * h + 1; c <= 2 * h + 2 && c < rq->size; c++) {
+            if (reorder_key(products, rq->heap[c]) <= 0) stack[top++] = c;
+        }
+    }
+    printf("--------------------------------------------------------------------------------\n");
+    printf("%d product(s) need reordering.\n", found);
+}
+
+/*
+@function: Menu_CustomerHistory
+@desc: Prints every sale and return of one customer in the current store, using the
+       customer index so only that customer's records are visited.
+@param: store - Store shard to search
+@return: void
+*/
+void Menu_CustomerHistory(StoreShard* store) {
+    char customer[STR_LEN];
+    float total = 0.0;
+    int found = 0;
+
+    printf("Enter Customer Name: ");
+    if (scanf("%49[^\n]", customer) != 1) {
+        clear_buffer();
+        printf("Error: Customer name cannot be empty.\n");
+        return;
+    }
+    clear_buffer();
+
+    printf("\n--- Purchase History: %s ---\n", customer);
+    printf("%-15s %-30s %-10s %-10s\n", "Date", "Product", "Qty", "Amount");
+    for (int i = CustomerFirstSale(&store->customers, store->sales, customer); i != -1; i = store->customers.next_sale[i]) {
+        SaleRecord* sale = &store->sales[i];
+        char p_name[STR_LEN] = "Unknown";
+        float p_price = 0.0;
+        int p_idx = ProductFindSlot(&store->product_ids, store->products, sale->product_id);
+        if (p_idx != -1) {
+            strcpy(p_name, store->products[p_idx].product_name);
+            p_price = store->products[p_idx].price;
+        }
+        // Returns are stored as negative quantities and show up as refunds
+        printf("%-15s %-30s %-10d $%-10.2f\n", sale->sale_date, p_name, sale->quantity_sold, sale->quantity_sold * p_price);
+        total += sale->quantity_sold * p_price;
+        found++;
+    }
+    printf("------------------------------------------------------------\n");
+    printf("%d record(s). Net Spend: $%.2f\n", found, total);
+}
+
+/*
+@function: Menu_ProcessReturn
+@desc: Handles a return: lists the customer's purchases, restocks the chosen product and
+       records a negative ledger entry so revenue and monthly reports net out the refund.
+       A product cannot be returned beyond what the customer has bought of it, net of
+       earlier returns.
+@param: store - Store shard the original sale belongs to
+@return: void
+*/
+void Menu_ProcessReturn(StoreShard* store) {
+    if (store->s_count >= MAX_SALES) {
+        printf("Error: Sales database full.\n");
+        return;
+    }
+    char customer[STR_LEN], date[15];
+    int purchases[MAX_SALES];
+    int n = 0, choice, qty;
+
+    // 1. Find the customer's purchases through the index
+    printf("Enter Customer Name: ");
+    if (scanf("%49[^\n]", customer) != 1) {
+        clear_buffer();
+        printf("Error: Customer name cannot be empty.\n");
+        return;
+    }
+    clear_buffer();
+    printf("\n%-5s %-15s %-10s %-10s\n", "No.", "Date", "Product ID", "Qty");
+    for (int i = CustomerFirstSale(&store->customers, store->sales, customer); i != -1; i = store->customers.next_sale[i]) {
+        if (store->sales[i].quantity_sold <= 0) continue; // Skip earlier returns
+        purchases[n++] = i;
+        printf("%-5d %-15s %-10d %-10d\n", n, store->sales[i].sale_date, store->sales[i].product_id, store->sales[i].quantity_sold);
+    }
+    if (n == 0) {
+        printf("Error: No purchases found for this customer.\n");
+        return;
+    }
+
+    // 2. Select the original sale
+    printf("Select purchase to return: ");
+    if (scanf("%d", &choice) != 1 || choice < 1 || choice > n) {
+        clear_buffer();
+        printf("Invalid selection.\n");
+        return;
+    }
+    clear_buffer();
+    SaleRecord* original = &store->sales[purchases[choice - 1]];
+
+    int p_idx = ProductFindSlot(&store->product_ids, store->products, original->product_id);
+    if (p_idx == -1) {
+        printf("Error: Product ID not found.\n");
+        return;
+    }
+
+    // 3. Units of this product still held by the customer after earlier returns
+    int held = 0;
+    for (int i = CustomerFirstSale(&store->customers, store->sales, customer); i != -1; i = store->customers.next_sale[i]) {
+        if (store->sales[i].product_id == original->product_id) held += store->sales[i].quantity_sold;
+    }
+    int returnable = original->quantity_sold < held ? original->quantity_sold : held;
+    if (returnable <= 0) {
+        printf("Error: This purchase has already been returned.\n");
+        return;
+    }
+
+    printf("Enter Quantity to Return (max %d): ", returnable);
+    if (scanf("%d", &qty) != 1 || qty < 1 || qty > returnable) {
+        clear_buffer();
+        printf("Error: Invalid return quantity.\n");
+        return;
+    }
+    clear_buffer();
+    printf("Enter Return Date (DD/MM/YYYY): "); scanf("%14s", date); clear_buffer();
+
+    int return_day = ParseLedgerDate(date);
+    if (return_day < 0) {
+        printf("Error: Invalid date, expected DD/MM/YYYY.\n");
+        return;
+    }
+    if (return_day < DateToDays(original->sale_date)) {
+        printf("Error: Return date is earlier than the sale date (%s).\n", original->sale_date);
+        return;
+    }
+
+    // 4. Restock the product
+    store->products[p_idx].quantity_in_stock += qty;
+
+    // 5. Record the refund as a negative ledger entry
+    SaleRecord* s = &store->sales[store->s_count];
+    s->product_id = original->product_id;
+    s->quantity_sold = -qty;
+    strcpy(s->customer_name, original->customer_name);
+    strcpy(s->sale_date, date);
+    store->s_count++;
+
+    // 6. Keep the reorder queue and customer index in sync; returns leave sales velocity alone
+    ReorderUpdate(&store->reorder, store->products, p_idx);
+    CustomerIndexAdd(&store->customers, store->sales, store->s_count - 1);
+
+    // 7. Save to files
+    AppendSaleToFile(s, store->sales_file);
+    SaveProducts(store->products, store->p_count, store->products_file);
+    printf("Return processed. Refund: $%.2f. Stock updated.\n", qty * store->products[p_idx].price);
+}
+
+/*
+@function: Menu_SwitchStore
+@desc: Lists the configured stores and selects the one operational commands act on.
+@param: shards[] - Array of store shards
+@param: store_count - Number of stores
+@param: store - Pointer to the current store, updated on success
+@return: void
+*/
+void Menu_SwitchStore(StoreShard shards[], int store_count, StoreShard** store) {
+    int store_id;
+
+    printf("\n%-8s %-25s %-10s %-10s\n", "Store", "Name", "Products", "Sales");
+    printf("------------------------------------------------------------\n");
+    for (int i = 0; i < store_count; i++) {
+        printf("%-8d %-25s %-10d %-10d\n", shards[i].store_id, shards[i].store_name,
+            shards[i].p_count, shards[i].s_count);
+    }
+
+    printf("Enter Store ID: ");
+    if (scanf("%d", &store_id) != 1) {
+        clear_buffer();
+        return;
+    }
+    clear_buffer();
+
+    StoreShard* target = FindStore(shards, store_count, store_id);
+    if (target == NULL) {
+        printf("Error: Store ID not found.\n");
+        return;
+    }
+    *store = target;
+    printf("Switched to store %d (%s).\n", target->store_id, target->store_name);
+}
+
+/*
+@function: Menu_ChainRevenueReport
+@desc: Calculates revenue for the target year across all stores. Each shard is totalled
+       on a worker thread and the partial results are merged here.
+@param: pool - Report thread pool
+@param: shards[] - Array of store shards
+@param: store_count - Number of stores
+@return: void
+*/
+void Menu_ChainRevenueReport(ShardPool* pool, StoreShard shards[], int store_count) {
+    RevenuePartial partials[MAX_STORES];
+    int target_year = 2025; // Same target year as the single-store report
+    float total_revenue = 0.0;
+    int total_records = 0;
+
+    RunShardFanOut(pool, shards, store_count, revenue_shard_task, partials, sizeof(RevenuePartial), &target_year);
+
+    printf("\n--- Chain-wide Revenue Report (Year: %d) ---\n", target_year);
+    printf("%-8s %-25s %-10s %-10s\n", "Store", "Name", "Records", "Revenue");
+    for (int i = 0; i < store_count; i++) {
+        printf("%-8d %-25s %-10d $%-10.2f\n", shards[i].store_id, shards[i].store_name,
+            partials[i].records, partials[i].revenue);
+        total_revenue += partials[i].revenue;
+        total_records += partials[i].records;
+    }
+    printf("------------------------------------------------------------\n");
+    printf("Total Revenue: $%.2f (%d records across %d stores)\n", total_revenue, total_records, store_count);
+}
+
+/*
+@function: Menu_ChainMonthlyReport
+@desc: Filters sales of a user-specified month/year in every store in parallel and
+       merges the matches into one chain-wide report file, grouped by store.
+@param: pool - Report thread pool
+@param: shards[] - Array of store shards
+@param: store_count - Number of stores
+@return: void
+*/
+void Menu_ChainMonthlyReport(ShardPool* pool, StoreShard shards[], int store_count) {
+    static MonthlyPartial partials[MAX_STORES]; // Static: one match list per store
+    char target_month[10];
+    char filename[60];
+    const char* month_full[12] = {
+        "January", "February", "March", "April", "May", "June",
+        "July", "August", "September", "October", "November", "December"
+    };
+
+    printf("Enter Month/Year (MM/YYYY): ");
+    scanf("%9s", target_month);
+    clear_buffer();
+
+    int mo = ParseMonthYear(target_month);
+    if (mo == 0) {
+        printf("Error: Invalid month, expected MM/YYYY.\n");
+        return;
+    }
+    sprintf(filename, "%s_Chain_Sales_Report_2559321.txt", month_full[mo - 1]);
+
+    RunShardFanOut(pool, shards, store_count, monthly_shard_task, partials, sizeof(MonthlyPartial), target_month);
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Error creating file.\n");
+        return;
+    }
+
+    fprintf(fp, "--- Chain-wide Monthly Sales Report: %s ---\n", target_month);
+    fprintf(fp, "%-8s %-10s %-20s %-10s %-10s\n", "Store", "Date", "Product Name", "Qty Sold", "Price");
+
+    // Merge shard results in store order
+    int found = 0;
+    float total_revenue = 0.0;
+    for (int i = 0; i < store_count; i++) {
+        MonthlyPartial* part = &partials[i];
+        for (int k = 0; k < part->count; k++) {
+            SaleRecord* sale = &shards[i].sales[part->sale_idx[k]];
+            int p_idx = part->product_idx[k];
+            fprintf(fp, "%-8d %-10s %-20s %-10d $%-10.2f\n", shards[i].store_id, sale->sale_date,
+                p_idx >= 0 ? shards[i].products[p_idx].product_name : "Unknown", sale->quantity_sold,
+                p_idx >= 0 ? shards[i].products[p_idx].price : 0.0f);
+        }
+        found += part->count;
+        total_revenue += part->revenue;
+    }
+    fprintf(fp, "Total Revenue: $%.2f\n", total_revenue);
+    fclose(fp);
+    printf("Report generated: %s (%d records found across %d stores)\n", filename, found, store_count);
+}
+
+/* ================== Store Shards ================== */
+
+/*
+@function: LoadStores
+@desc: Reads the store list. Each line is: id,"name","products file","sales file".
+@param: shards[] - Array to store the store definitions
+@param: store_count - Pointer to update the count of stores
+@param: filename - Name of the file to read
+@return: int - 1 if at least one store was read, 0 otherwise
+*/
+int LoadStores(StoreShard shards[], int* store_count, const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return 0;
+    char line[256];
+    *store_count = 0;
+    while (fgets(line, sizeof(line), file) && *store_count < MAX_STORES) {
+        StoreShard* store = &shards[*store_count];
+        if (sscanf(line, "%d,\"%49[^\"]\",\"%49[^\"]\",\"%49[^\"]\"",
+            &store->store_id, store->store_name, store->products_file, store->sales_file) != 4) continue;
+
+        // Each store needs its own ID and its own files, or saves would overwrite each other
+        int clash = 0;
+        for (int i = 0; i < *store_count && !clash; i++) {
+            if (shards[i].store_id == store->store_id) {
+                printf("Warning: Duplicate store ID %d in %s, line skipped.\n", store->store_id, filename);
+                clash = 1;
+            }
+            else if (strcmp(shards[i].products_file, store->products_file) == 0 || strcmp(shards[i].sales_file, store->sales_file) == 0 ||
+                strcmp(shards[i].products_file, store->sales_file) == 0 || strcmp(shards[i].sales_file, store->products_file) == 0) {
+                printf("Warning: Store %d shares data files with store %d, line skipped.\n", store->store_id, shards[i].store_id);
+                clash = 1;
+            }
+        }
+        if (!clash && strcmp(store->products_file, store->sales_file) == 0) {
+            printf("Warning: Store %d uses one file for products and sales, line skipped.\n", store->store_id);
+            clash = 1;
+        }
+        if (clash) continue;
+        (*store_count)++;
+    }
+    fclose(file);
+    return *store_count > 0;
+}
+
+/*
+@function: LoadStoreShard
+@desc: Loads one store's products and sales from its own files and builds its reorder queue.
+@param: store - Store shard with its file names set
+@return: void
+*/
+void LoadStoreShard(StoreShard* store) {
+    store->p_count = 0;
+    store->s_count = 0;
+
+    if (!LoadProducts(store->products, &store->p_count, store->products_file)) {
+        printf("Warning: Store %d failed to load products or file empty.\n", store->store_id);
+    }
+    else {
+        printf("Store %d: Loaded %d products.\n", store->store_id, store->p_count);
+    }
+
+    if (!LoadSalesData(store->sales, &store->s_count, store->sales_file)) {
+        printf("Warning: Store %d failed to load sales or file empty.\n", store->store_id);
+    }
+    else {
+        printf("Store %d: Loaded %d sales records.\n", store->store_id, store->s_count);
+    }
+
+    // Build the reorder queue and customer index from the imported catalog and ledger
+    ReorderBuild(&store->reorder, store->products, store->p_count, store->sales, store->s_count);
+    CustomerIndexBuild(&store->customers, store->sales, store->s_count);
+    ProductIndexBuild(&store->product_ids, store->products, store->p_count);
+}
+
+/*
+@function: FindStore
+@desc: Looks up a store shard by its ID.
+@param: shards[] - Array of store shards
+@param: store_count - Number of stores
+@param: store_id - ID to look for
+@return: StoreShard* - The matching shard, or NULL if not found
+*/
+StoreShard* FindStore(StoreShard shards[], int store_count, int store_id) {
+    for (int i = 0; i < store_count; i++) {
+        if (shards[i].store_id == store_id) return &shards[i];
+    }
+    return NULL;
+}
+
+/*
+@function: shard_pool_run
+@desc: Claims shards of a job one at a time and runs the task on them until none are left.
+@param: pool - Report thread pool whose lock guards the job's next counter
+@param: job - Fan-out job to work on
+@return: void
+*/
+void shard_pool_run(ShardPool* pool, ShardFanOut* job) {
+    while (1) {
+        mtx_lock(&pool->lock);
+        int i = job->next++;
+        mtx_unlock(&pool->lock);
+        if (i >= job->store_count) break;
+        job->task(&job->shards[i], (char*)job->results + i * job->result_size, job->arg);
+    }
+}
+
+/*
+@function: shard_worker
+@desc: Thread body of a pool worker: waits for each new job, helps run it, then checks in.
+@param: arg - Pointer to the ShardPool
+@return: int - Never returns; workers live until the process exits
+*/
+int shard_worker(void* arg) {
+    ShardPool* pool = (ShardPool*)arg;
+    int seen = 0;
+
+    mtx_lock(&pool->lock);
+    while (1) {
+        while (pool->generation == seen) cnd_wait(&pool->work_ready, &pool->lock);
+        seen = pool->generation;
+        ShardFanOut* job = pool->job;
+        mtx_unlock(&pool->lock);
+
+        shard_pool_run(pool, job);
+
+        mtx_lock(&pool->lock);
+        if (--pool->active == 0) cnd_signal(&pool->work_done);
+    }
+    return 0;
+}
+
+/*
+@function: ShardPoolStart
+@desc: Starts the report worker threads. If synchronisation objects or threads cannot be
+       created, the pool runs with fewer (or no) workers and jobs fall back to the caller.
+@param: pool - Report thread pool to initialise
+@return: void
+*/
+void ShardPoolStart(ShardPool* pool) {
+    pool->thread_count = 0;
+    pool->job = NULL;
+    pool->generation = 0;
+    pool->active = 0;
+
+    if (mtx_init(&pool->lock, mtx_plain) != thrd_success) return;
+    if (cnd_init(&pool->work_ready) != thrd_success || cnd_init(&pool->work_done) != thrd_success) return;
+
+    for (int t = 1; t < REPORT_THREADS; t++) {
+        if (thrd_create(&pool->threads[pool->thread_count], shard_worker, pool) == thrd_success) pool->thread_count++;
+    }
+}
+
+/*
+@function: RunShardFanOut
+@desc: Runs a task on every store shard using the pool workers plus the calling thread, and
+       returns once all per-shard results are filled in. Shards are only read, so no locking
+       is needed inside the task.
+@param: pool - Report thread pool
+@param: shards[] - Array of store shards
+@param: store_count - Number of stores
+@param: task - Function computing one shard's partial result
+@param: results - Array of store_count results, indexed like shards
+@param: result_size - Size of one result in bytes
+@param: arg - Shared task parameters
+@return: void
+*/
+void RunShardFanOut(ShardPool* pool, StoreShard shards[], int store_count, ShardTask task, void* results, size_t result_size, void* arg) {
+    ShardFanOut job;
+    job.shards = shards;
+    job.store_count = store_count;
+    job.task = task;
+    job.results = results;
+    job.result_size = result_size;
+    job.arg = arg;
+    job.next = 0;
+
+    // Without workers, or with a single store, there is nothing to hand out
+    if (pool->thread_count == 0 || store_count < 2) {
+        for (int i = 0; i < store_count; i++) task(&shards[i], (char*)results + i * result_size, arg);
+        return;
+    }
+
+    // Post the job and wake the workers
+    mtx_lock(&pool->lock);
+    pool->job = &job;
+    pool->active = pool->thread_count;
+    pool->generation++;
+    cnd_broadcast(&pool->work_ready);
+    mtx_unlock(&pool->lock);
+
+    shard_pool_run(pool, &job);
+
+    // job lives on this stack frame, so wait until every worker has let go of it
+    mtx_lock(&pool->lock);
+    while (pool->active > 0) cnd_wait(&pool->work_done, &pool->lock);
+    mtx_unlock(&pool->lock);
+}
+
+/*
+@function: revenue_shard_task
+@desc: Shard task for the chain revenue report: totals one store's revenue for a year.
+@param: store - Store shard to scan
+@param: result - RevenuePartial to fill
+@param: arg - Pointer to the target year
+@return: void
+*/
+void revenue_shard_task(StoreShard* store, void* result, void* arg) {
+    RevenuePartial* part = (RevenuePartial*)result;
+    int target_year = *(int*)arg;
+
+    part->revenue = 0.0;
+    part->records = 0;
+    for (int i = 0; i < store->s_count; i++) {
+        // Extract year from date string "DD/MM/YYYY" (offset +6)
+        if (atoi(&store->sales[i].sale_date[6]) != target_year) continue;
+        for (int j = 0; j < store->p_count; j++) {
+            if (store->products[j].product_id == store->sales[i].product_id) {
+                part->revenue += store->sales[i].quantity_sold * store->products[j].price;
+                part->records++;
+                break;
+            }
+        }
+    }
+}
+
+/*
+@function: monthly_shard_task
+@desc: Shard task for the chain monthly report: collects one store's sales for a month.
+@param: store - Store shard to scan
+@param: result - MonthlyPartial to fill
+@param: arg - Target month string (MM/YYYY)
+@return: void
+*/
+void monthly_shard_task(StoreShard* store, void* result, void* arg) {
+    MonthlyPartial* part = (MonthlyPartial*)result;
+    const char* target_month = (const char*)arg;
+
+    part->count = 0;
+    part->revenue = 0.0;
+    for (int i = 0; i < store->s_count; i++) {
+        // Match the MM/YYYY part of "DD/MM/YYYY" exactly
+        if (strcmp(&store->sales[i].sale_date[3], target_month) != 0) continue;
+        int p_idx = -1;
+        for (int j = 0; j < store->p_count; j++) {
+            if (store->products[j].product_id == store->sales[i].product_id) {
+                p_idx = j;
+                part->revenue += store->sales[i].quantity_sold * store->products[j].price;
+                break;
+            }
+        }
+        part->sale_idx[part->count] = i;
+        part->product_idx[part->count] = p_idx;
+        part->count++;
+    }
+}
+
+/* ================== Reorder Engine ================== */
+
+/*
+@function: reorder_key
+@desc: Heap key of a product: stock remaining above its reorder threshold.
+@param: products[] - Array of products
+@param: idx - Product slot
+@return: int - Key value, <= 0 means the product needs reordering
+*/
+int reorder_key(Product products[], int idx) {
+    return products[idx].quantity_in_stock - products[idx].reorder_threshold;
+}
+
+/*
+@function: reorder_swap
+@desc: Swaps two heap positions and keeps the position index in sync.
+@param: rq - Reorder queue
+@param: a - First heap position
+@param: b - Second heap position
+@return: void
+*/
+void reorder_swap(ReorderQueue* rq, int a, int b) {
+    int temp = rq->heap[a];
+    rq->heap[a] = rq->heap[b];
+    rq->heap[b] = temp;
+    rq->pos[rq->heap[a]] = a;
+    rq->pos[rq->heap[b]] = b;
+}
+
+/*
+@function: reorder_sift_up
+@desc: Moves a heap entry towards the root while its key is smaller than its parent's.
+@param: rq - Reorder queue
+@param: products[] - Array of products
+@param: h - Heap position to sift
+@return: void
+*/
+void reorder_sift_up(ReorderQueue* rq, Product products[], int h) {
+    while (h > 0) {
+        int parent = (h - 1) / 2;
+        if (reorder_key(products, rq->heap[parent]) <= reorder_key(products, rq->heap[h])) break;
+        reorder_swap(rq, h, parent);
+        h = parent;
+    }
+}
+
+/*
+@function: reorder_sift_down
+@desc: Moves a heap entry towards the leaves while a child has a smaller key.
+@param: rq - Reorder queue
+@param: products[] - Array of products
+@param: h - Heap position to sift
+@return: void
+*/
+void reorder_sift_down(ReorderQueue* rq, Product products[], int h) {
+    while (1) {
+        int smallest = h;
+        for (int c = 2 * h + 1; c <= 2 * h + 2 && c < rq->size; c++) {
+            if (reorder_key(products, rq->heap[c]) < reorder_key(products, rq->heap[smallest])) smallest = c;
+        }
+        if (smallest == h) break;
+        reorder_swap(rq, h, smallest);
+        h = smallest;
+    }
+}
+
+/*
+@function: reorder_reset_velocity
+@desc: Clears the recent sales buckets of one product slot.
+@param: rq - Reorder queue
+@param: idx - Product slot
+@return: void
+*/
+void reorder_reset_velocity(ReorderQueue* rq, int idx) {
+    for (int b = 0; b < VELOCITY_WINDOW_DAYS; b++) {
+        rq->bucket_day[idx][b] = -1;
+        rq->bucket_qty[idx][b] = 0;
+    }
+}
+
+/*
+@function: ReorderBuild
+@desc: Rebuilds the reorder queue from scratch: loads recent sales velocity from the
+       ledger and heapifies all products in O(n). Used after import and after sorting,
+       which moves products between slots.
+@param: rq - Reorder queue to fill
+@param: products[] - Array of products
+@param: p_count - Number of products
+@param: sales[] - Array of sales
+@param: s_count - Number of sales
+@return: void
+*/
+void ReorderBuild(ReorderQueue* rq, Product products[], int p_count, SaleRecord sales[], int s_count) {
+    rq->size = p_count;
+    rq->latest_day = -1;
+    for (int i = 0; i < p_count; i++) {
+        rq->heap[i] = i;
+        rq->pos[i] = i;
+        reorder_reset_velocity(rq, i);
+    }
+
+    // Replay the ledger into the velocity buckets, skipping returns
+    for (int i = 0; i < s_count; i++) {
+        if (sales[i].quantity_sold <= 0) continue;
+        for (int j = 0; j < p_count; j++) {
+            if (products[j].product_id == sales[i].product_id) {
+                ReorderRecordSale(rq, j, sales[i].sale_date, sales[i].quantity_sold);
+                break;
+            }
+        }
+    }
+
+    // Bottom-up heapify
+    for (int h = p_count / 2 - 1; h >= 0; h--) {
+        reorder_sift_down(rq, products, h);
+    }
+}
+
+/*
+@function: ReorderInsert
+@desc: Adds a newly created product slot to the reorder queue in O(log n).
+@param: rq - Reorder queue
+@param: products[] - Array of products
+@param: idx - Slot of the new product
+@return: void
+*/
+void ReorderInsert(ReorderQueue* rq, Product products[], int idx) {
+    reorder_reset_velocity(rq, idx);
+    rq->heap[rq->size] = idx;
+    rq->pos[idx] = rq->size;
+    rq->size++;
+    reorder_sift_up(rq, products, rq->pos[idx]);
+}
+
+/*
+@function: ReorderUpdate
+@desc: Restores heap order after a product's stock or threshold changed, in O(log n).
+@param: rq - Reorder queue
+@param: products[] - Array of products
+@param: idx - Slot of the changed product
+@return: void
+*/
+void ReorderUpdate(ReorderQueue* rq, Product products[], int idx) {
+    reorder_sift_up(rq, products, rq->pos[idx]);
+    reorder_sift_down(rq, products, rq->pos[idx]);
+}
+
+/*
+@function: ReorderRecordSale
+@desc: Adds a sale to a product's recent sales buckets. Each bucket holds one day;
+       a sale older than the day already in its bucket is outside any window and dropped.
+       Returns (negative ledger entries) are not recorded, so velocity counts units sold.
+@param: rq - Reorder queue
+@param: idx - Product slot
+@param: date - Sale date string (DD/MM/YYYY)
+@param: qty - Units sold, ignored unless positive
+@return: void
+*/
+void ReorderRecordSale(ReorderQueue* rq, int idx, const char* date, int qty) {
+    int day = DateToDays(date);
+    if (day < 0 || qty <= 0) return;
+
+    int b = day % VELOCITY_WINDOW_DAYS;
+    if (rq->bucket_day[idx][b] == day) {
+        rq->bucket_qty[idx][b] += qty;
+    }
+    else if (day > rq->bucket_day[idx][b]) {
+        rq->bucket_day[idx][b] = day;
+        rq->bucket_qty[idx][b] = qty;
+    }
+    if (day > rq->latest_day) rq->latest_day = day;
+}
+
+/*
+@function: DateToDays
+@desc: Converts a "DD/MM/YYYY" date into a day number so dates can be compared and subtracted.
+@param: date - Date string
+@return: int - Days since 01/03/0000, or -1 if the date cannot be parsed
+*/
+int DateToDays(const char* date) {
+    int d, m, y;
+    if (sscanf(date, "%d/%d/%d", &d, &m, &y) != 3 || d < 1 || d > 31 || m < 1 || m > 12 || y < 1) return -1;
+    // Count years from March so the leap day is the last day of the year
+    if (m <= 2) {
+        y--;
+        m += 12;
+    }
+    return 365 * y + y / 4 - y / 100 + y / 400 + (153 * (m - 3) + 2) / 5 + d - 1;
+}
+
+/*
+@function: ParseLedgerDate
+@desc: Validates a date typed in for a sale or return. Reports read the year at a fixed
+       offset, so the exact DD/MM/YYYY layout is required, not just a parsable date.
+@param: date - Date string
+@return: int - Day number as from DateToDays, or -1 if the date is invalid
+*/
+int ParseLedgerDate(const char* date) {
+    if (strlen(date) != 10 || date[2] != '/' || date[5] != '/') return -1;
+    return DateToDays(date);
+}
+
+/*
+@function: ParseMonthYear
+@desc: Validates a "MM/YYYY" month string as typed into the monthly reports.
+@param: text - Month string
+@return: int - Month number 1-12, or 0 if the string is not exactly MM/YYYY
+*/
+int ParseMonthYear(const char* text) {
+    if (strlen(text) != 7 || text[2] != '/') return 0;
+    for (int i = 0; i < 7; i++) {
+        if (i != 2 && (text[i] < '0' || text[i] > '9')) return 0;
+    }
+    int mo = (text[0] - '0') * 10 + text[1] - '0';
+    return (mo >= 1 && mo <= 12) ? mo : 0;
+}
+
+/* ================== Customer Index ================== */
+
+/*
+@function: customer_slot
+@desc: Finds the hash slot holding a customer, or the empty slot where it would go.
+@param: ci - Customer index
+@param: sales[] - Array of sales the index points into
+@param: name - Customer name
+@return: int - Slot number
+*/
+int customer_slot(CustomerIndex* ci, SaleRecord sales[], const char* name) {
+    unsigned int hash = 5381;
+    for (const char* c = name; *c; c++) hash = hash * 33 + (unsigned char)*c;
+
+    // Linear probing; the table is never more than half full
+    int slot = hash % CUSTOMER_SLOTS;
+    while (ci->first_sale[slot] != -1 && strcmp(sales[ci->first_sale[slot]].customer_name, name) != 0) {
+        slot = (slot + 1) % CUSTOMER_SLOTS;
+    }
+    return slot;
+}
+
+/*
+@function: CustomerIndexBuild
+@desc: Indexes every sale in the ledger by customer name.
+@param: ci - Customer index to fill
+@param: sales[] - Array of sales
+@param: s_count - Number of sales
+@return: void
+*/
+void CustomerIndexBuild(CustomerIndex* ci, SaleRecord sales[], int s_count) {
+    for (int i = 0; i < CUSTOMER_SLOTS; i++) {
+        ci->first_sale[i] = -1;
+        ci->last_sale[i] = -1;
+    }
+    for (int i = 0; i < s_count; i++) {
+        CustomerIndexAdd(ci, sales, i);
+    }
+}
+
+/*
+@function: CustomerIndexAdd
+@desc: Appends one ledger entry to its customer's list.
+@param: ci - Customer index
+@param: sales[] - Array of sales
+@param: offset - Ledger offset of the new entry
+@return: void
+*/
+void CustomerIndexAdd(CustomerIndex* ci, SaleRecord sales[], int offset) {
+    int slot = customer_slot(ci, sales, sales[offset].customer_name);
+    ci->next_sale[offset] = -1;
+    if (ci->first_sale[slot] == -1) ci->first_sale[slot] = offset;
+    else ci->next_sale[ci->last_sale[slot]] = offset;
+    ci->last_sale[slot] = offset;
+}
+
+/*
+@function: CustomerFirstSale
+@desc: Looks up a customer's first ledger entry; follow next_sale for the rest.
+@param: ci - Customer index
+@param: sales[] - Array of sales
+@param: name - Customer name (exact match)
+@return: int - Ledger offset, or -1 if the customer has no records
+*/
+int CustomerFirstSale(CustomerIndex* ci, SaleRecord sales[], const char* name) {
+    return ci->first_sale[customer_slot(ci, sales, name)];
+}
+
+/* ================== Product ID Index ================== */
+
+/*
+@function: product_id_slot
+@desc: Finds the hash slot holding a product ID, or the empty slot where it would go.
+@param: pi - Product ID index
+@param: products[] - Array of products the index points into
+@param: product_id - Product ID
+@return: int - Hash slot number
+*/
+int product_id_slot(ProductIndex* pi, Product products[], int product_id) {
+    // Linear probing; the table is never more than half full
+    int h = (unsigned int)product_id % PRODUCT_SLOTS;
+    while (pi->slot[h] != -1 && products[pi->slot[h]].product_id != product_id) {
+        h = (h + 1) % PRODUCT_SLOTS;
+    }
+    return h;
+}
+
+/*
+@function: ProductIndexBuild
+@desc: Indexes every product in the catalog by its ID.
+@param: pi - Product ID index to fill
+@param: products[] - Array of products
+@param: p_count - Number of products
+@return: void
+*/
+void ProductIndexBuild(ProductIndex* pi, Product products[], int p_count) {
+    for (int h = 0; h < PRODUCT_SLOTS; h++) {
+        pi->slot[h] = -1;
+    }
+    for (int i = 0; i < p_count; i++) {
+        ProductIndexAdd(pi, products, i);
+    }
+}
+
+/*
+@function: ProductIndexAdd
+@desc: Adds one catalog slot to the index. If the ID is already present the earlier
+       product is kept, matching a front-to-back catalog search.
+@param: pi - Product ID index
+@param: products[] - Array of products
+@param: idx - Catalog slot of the product
+@return: void
+*/
+void ProductIndexAdd(ProductIndex* pi, Product products[], int idx) {
+    int h = product_id_slot(pi, products, products[idx].product_id);
+    if (pi->slot[h] == -1) pi->slot[h] = idx;
+}
+
+/*
+@function: ProductFindSlot
+@desc: Looks up the catalog slot of a product ID.
+@param: pi - Product ID index
+@param: products[] - Array of products
+@param: product_id - Product ID to look for
+@return: int - Catalog slot, or -1 if the product is not in the catalog
+*/
+int ProductFindSlot(ProductIndex* pi, Product products[], int product_id) {
+    return pi->slot[product_id_slot(pi, products, product_id)];
+}
+
 /* ================== File I/O Helpers ================== */
 
 /*
@@ -603,9 +1733,12 @@ void Menu_MonthlyReport(Product products[], int p_count, SaleRecord sales[], int
 */
 void parse_csv_line_product(char* line, Product* p) {
     // Scanset used to handle quoted strings containing commas/spaces
-    sscanf(line, "%d,\"%[^\"]\",\"%[^\"]\",%f,%d,%d,\"%[^\"]\"",
+    int fields = sscanf(line, "%d,\"%[^\"]\",\"%[^\"]\",%f,%d,%d,\"%[^\"]\",%d",
         &p->product_id, p->product_name, p->brand, &p->price,
-        &p->quantity_in_stock, &p->warranty.warranty_months, p->warranty.provider);
+        &p->quantity_in_stock, &p->warranty.warranty_months, p->warranty.provider,
+        &p->reorder_threshold);
+    // Older files have no threshold column
+    if (fields < 8) p->reorder_threshold = DEFAULT_REORDER_THRESHOLD;
 }
 
 /*
@@ -682,14 +1815,15 @@ void SaveProducts(Product products[], int p_count, const char* filename) {
         return;
     }
     for (int i = 0; i < p_count; i++) {
-        fprintf(file, "%d,\"%s\",\"%s\",%.2f,%d,%d,\"%s\"\n",
+        fprintf(file, "%d,\"%s\",\"%s\",%.2f,%d,%d,\"%s\",%d\n",
             products[i].product_id,
             products[i].product_name,
             products[i].brand,
             products[i].price,
             products[i].quantity_in_stock,
             products[i].warranty.warranty_months,
-            products[i].warranty.provider);
+            products[i].warranty.provider,
+            products[i].reorder_threshold);
     }
     fclose(file);
 }